@@ -0,0 +1,903 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w`.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c` for details.
+*/
+
+// ============= FLUENT LIB C =============
+// Remez Minimax Coefficient Generator
+// ----------------------------------------
+// A host-side tool that fits a minimax polynomial to one of the library's
+// reference functions and writes the coefficients as a C header:
+// - Remez exchange over n + 2 alternation points
+// - Double-double (~106-bit) function values, linear solves and error
+//   curves, so the fit is limited by the final rounding to double only
+// - Absolute or relative error, full, odd or even polynomials
+// - The emitted error bound is measured with the rounded coefficients
+//
+// Usage:
+//   std_math_remez <function> <a> <b> <degree> [--relative] [--odd | --even]
+//                  [--name NAME] [--output FILE]
+//
+// <function> is one of sin, cos, exp, expm1, log, log1p. With --odd or
+// --even, <degree> counts the terms kept (x, x^3, ... or 1, x^2, ...) and
+// the interval must not contain negative values; the symmetric half is
+// implied. log needs a > 0, log1p a > -1 and exp, expm1 b <= 690; the
+// tool exits nonzero, writing nothing, if the fit breaks down anyway.
+//
+// Coefficients are in powers of x, so intervals far from the origin are
+// ill-conditioned once rounded to double: fit log1p on [0, 1] rather than
+// log on [1, 2]. The measured error in the header shows such losses.
+//
+// Unlike the library itself this tool needs a hosted C runtime (stdio),
+// which is why CMake keeps it out of the default build.
+
+#include <ctype.h>
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "std_math.h"
+
+#define REMEZ_MAX_TERMS 32
+#define REMEZ_MAX_ITERATIONS 60
+#define REMEZ_GRID_PER_POINT 128
+#define REMEZ_GOLDEN_STEPS 60
+
+#define REMEZ_FULL 0
+#define REMEZ_ODD 1
+#define REMEZ_EVEN 2
+
+// ============= DOUBLE-DOUBLE ARITHMETIC =============
+/**
+ * An unevaluated sum hi + lo with |lo| <= ulp(hi) / 2.
+ */
+typedef struct
+{
+    double hi;
+    double lo;
+} dd_t;
+
+static dd_t dd_from(const double x)
+{
+    const dd_t result = {x, 0.0};
+    return result;
+}
+
+static dd_t dd_normalize(const double hi, const double lo)
+{
+    dd_t result;
+    result.hi = num_fast_two_sum(hi, lo, &result.lo);
+    return result;
+}
+
+static dd_t dd_neg(const dd_t a)
+{
+    const dd_t result = {-a.hi, -a.lo};
+    return result;
+}
+
+static dd_t dd_add(const dd_t a, const dd_t b)
+{
+    double e;
+    double f;
+    const double s = num_two_sum(a.hi, b.hi, &e);
+    const double t = num_two_sum(a.lo, b.lo, &f);
+    const dd_t partial = dd_normalize(s, e + t);
+
+    return dd_normalize(partial.hi, partial.lo + f);
+}
+
+static dd_t dd_sub(const dd_t a, const dd_t b)
+{
+    return dd_add(a, dd_neg(b));
+}
+
+static dd_t dd_mul(const dd_t a, const dd_t b)
+{
+    double e;
+    const double p = num_two_prod(a.hi, b.hi, &e);
+
+    return dd_normalize(p, e + (a.hi * b.lo + a.lo * b.hi));
+}
+
+static dd_t dd_mul_d(const dd_t a, const double b)
+{
+    double e;
+    const double p = num_two_prod(a.hi, b, &e);
+
+    return dd_normalize(p, e + a.lo * b);
+}
+
+static dd_t dd_div(const dd_t a, const dd_t b)
+{
+    // Three quotient digits, each from the remainder of the previous ones
+    const double q1 = a.hi / b.hi;
+    dd_t r = dd_sub(a, dd_mul_d(b, q1));
+    const double q2 = r.hi / b.hi;
+    r = dd_sub(r, dd_mul_d(b, q2));
+    const double q3 = r.hi / b.hi;
+
+    return dd_add(dd_normalize(q1, q2), dd_from(q3));
+}
+
+/**
+ * Multiplies by 2^k, exact barring overflow and underflow.
+ */
+static dd_t dd_scale2(const dd_t a, const int k)
+{
+    const dd_t result = {num_ldexp(a.hi, k), num_ldexp(a.lo, k)};
+    return result;
+}
+
+static double dd_to_double(const dd_t a)
+{
+    return a.hi + a.lo;
+}
+
+// ============= DOUBLE-DOUBLE REFERENCE FUNCTIONS =============
+static const dd_t dd_ln2 = {6.93147180559945286e-01, 2.31904681384629956e-17};
+static const dd_t dd_pi_2 = {1.57079632679489656e+00, 6.12323399573676604e-17};
+
+/**
+ * e^r - 1 for |r| <= 1/2, by Taylor series at r / 2^10 and ten doublings
+ * of the form e^2r - 1 = m * (m + 2), which keep the small result exact.
+ */
+static dd_t dd_expm1_reduced(const dd_t r)
+{
+    const dd_t x = dd_scale2(r, -10);
+    dd_t term = x;
+    dd_t sum = x;
+
+    for (int k = 2; k < 40 && num_fabs(term.hi) > 1e-36 * num_fabs(sum.hi); k++)
+    {
+        term = dd_div(dd_mul(term, x), dd_from((double)k));
+        sum = dd_add(sum, term);
+    }
+
+    for (int i = 0; i < 10; i++)
+    {
+        sum = dd_mul(sum, dd_add(sum, dd_from(2.0)));
+    }
+
+    return sum;
+}
+
+static dd_t dd_exp(const dd_t x)
+{
+    // x = k * ln2 + r with |r| <= ln2 / 2
+    const double k = std_math_round(x.hi * STD_MATH_INV_LN2);
+    const dd_t r = dd_sub(x, dd_mul_d(dd_ln2, k));
+
+    return dd_scale2(dd_add(dd_expm1_reduced(r), dd_from(1.0)), (int)k);
+}
+
+static dd_t dd_expm1(const dd_t x)
+{
+    if (num_fabs(x.hi) <= 0.5)
+    {
+        return dd_expm1_reduced(x);
+    }
+
+    return dd_sub(dd_exp(x), dd_from(1.0));
+}
+
+/**
+ * Sums the Taylor series of sin (first = 1) or cos (first = 0) at |r| <= pi/4.
+ */
+static dd_t dd_trig_series(const dd_t r, const int first)
+{
+    const dd_t r2 = dd_mul(r, r);
+    dd_t term = first ? r : dd_from(1.0);
+    dd_t sum = term;
+
+    for (int k = first + 1; k < 60 && num_fabs(term.hi) > 1e-36; k += 2)
+    {
+        term = dd_neg(dd_div(dd_mul(term, r2), dd_from((double)(k * (k + 1)))));
+        sum = dd_add(sum, term);
+    }
+
+    return sum;
+}
+
+/**
+ * sin(x) (phase = 0) or cos(x) (phase = 1), reduced by multiples of pi/2.
+ */
+static dd_t dd_sincos(const dd_t x, const int phase)
+{
+    const double k = std_math_round(x.hi * (2.0 / M_PI));
+    const dd_t r = dd_sub(x, dd_mul_d(dd_pi_2, k));
+    const int quadrant = ((int)((long long)k & 3) + phase) & 3;
+
+    switch (quadrant)
+    {
+        case 0: return dd_trig_series(r, 1);
+        case 1: return dd_trig_series(r, 0);
+        case 2: return dd_neg(dd_trig_series(r, 1));
+        default: return dd_neg(dd_trig_series(r, 0));
+    }
+}
+
+static dd_t dd_sin(const dd_t x)
+{
+    return dd_sincos(x, 0);
+}
+
+static dd_t dd_cos(const dd_t x)
+{
+    return dd_sincos(x, 1);
+}
+
+static dd_t dd_log(const dd_t x)
+{
+    // Newton on e^y = x from the double result; each step doubles the digits
+    dd_t y = dd_from(num_log(x.hi));
+
+    for (int i = 0; i < 2; i++)
+    {
+        y = dd_add(y, dd_sub(dd_mul(x, dd_exp(dd_neg(y))), dd_from(1.0)));
+    }
+
+    return y;
+}
+
+static dd_t dd_log1p(const dd_t x)
+{
+    // Newton on e^y - 1 = x, with expm1 so that small x keep their digits
+    dd_t y = dd_from(std_math_log1p(x.hi));
+
+    for (int i = 0; i < 2; i++)
+    {
+        const dd_t m = dd_expm1(y);
+        y = dd_sub(y, dd_div(dd_sub(m, x), dd_add(m, dd_from(1.0))));
+    }
+
+    return y;
+}
+
+typedef struct
+{
+    const char *name;
+    dd_t (*function)(dd_t x);
+    double above;                   // Fits need a > above
+    double upper;                   // and b <= upper
+    const char *domain;             // The same, for the error message
+} remez_function_t;
+
+// exp stops at 690 so that f, E and the two-product splits of both stay
+// below 2^996; the logarithms are undefined at and below their poles
+static const remez_function_t remez_functions[] = {
+    {"sin", dd_sin, -DBL_MAX, DBL_MAX, "finite a and b"},
+    {"cos", dd_cos, -DBL_MAX, DBL_MAX, "finite a and b"},
+    {"exp", dd_exp, -DBL_MAX, 690.0, "finite a and b <= 690"},
+    {"expm1", dd_expm1, -DBL_MAX, 690.0, "finite a and b <= 690"},
+    {"log", dd_log, 0.0, DBL_MAX, "a > 0"},
+    {"log1p", dd_log1p, -1.0, DBL_MAX, "a > -1"},
+};
+
+// ============= REMEZ EXCHANGE =============
+/**
+ * The problem being fitted and its current solution.
+ */
+typedef struct
+{
+    dd_t (*function)(dd_t x);
+    double requested_a;             // Lower end as given on the command line
+    double a;                       // Lower end sampled, nudged off a zero of f
+    double b;
+    size_t terms;                   // Number of coefficients
+    int symmetry;                   // REMEZ_FULL, REMEZ_ODD or REMEZ_EVEN
+    int relative;                   // Weight the error by 1 / |f|
+    dd_t coefficients[REMEZ_MAX_TERMS];
+    dd_t levelled_error;            // E from the last linear solve
+} remez_t;
+
+/**
+ * Evaluates the fitted polynomial: P(x), x * P(x^2) or P(x^2).
+ */
+static dd_t remez_poly(const remez_t *remez, const dd_t *coefficients, const double x)
+{
+    const dd_t v = remez->symmetry == REMEZ_FULL ? dd_from(x) : dd_mul(dd_from(x), dd_from(x));
+    dd_t result = coefficients[remez->terms - 1];
+
+    for (size_t i = remez->terms - 1; i-- > 0;)
+    {
+        result = dd_add(dd_mul(result, v), coefficients[i]);
+    }
+
+    return remez->symmetry == REMEZ_ODD ? dd_mul_d(result, x) : result;
+}
+
+/**
+ * Returns the weighted error (p(x) - f(x)) * w(x).
+ */
+static double remez_error(const remez_t *remez, const dd_t *coefficients, const double x)
+{
+    const dd_t f = remez->function(dd_from(x));
+    const dd_t e = dd_sub(remez_poly(remez, coefficients, x), f);
+
+    return remez->relative ? dd_to_double(dd_div(e, f)) : dd_to_double(e);
+}
+
+/**
+ * Solves sum_i c_i * phi_i(x_j) + (-1)^j * E / w(x_j) = f(x_j) for c and E.
+ *
+ * @return 0 on success, -1 if the system is singular.
+ */
+static int remez_solve(remez_t *remez, const double *reference)
+{
+    const size_t n = remez->terms + 1;
+    dd_t matrix[REMEZ_MAX_TERMS + 1][REMEZ_MAX_TERMS + 2];
+
+    for (size_t j = 0; j < n; j++)
+    {
+        const double x = reference[j];
+        const dd_t f = remez->function(dd_from(x));
+        const dd_t v = remez->symmetry == REMEZ_FULL ? dd_from(x) : dd_mul(dd_from(x), dd_from(x));
+        dd_t basis = remez->symmetry == REMEZ_ODD ? dd_from(x) : dd_from(1.0);
+
+        for (size_t i = 0; i < remez->terms; i++)
+        {
+            matrix[j][i] = basis;
+            basis = dd_mul(basis, v);
+        }
+
+        // Relative fits level (p - f) / |f|, so E enters scaled by |f(x_j)|
+        dd_t alternation = j % 2 ? dd_from(-1.0) : dd_from(1.0);
+
+        if (remez->relative)
+        {
+            alternation = dd_mul(alternation, f.hi < 0 ? dd_neg(f) : f);
+        }
+
+        matrix[j][n - 1] = alternation;
+        matrix[j][n] = f;
+    }
+
+    // Gaussian elimination with partial pivoting
+    for (size_t col = 0; col < n; col++)
+    {
+        size_t pivot = col;
+
+        for (size_t row = col + 1; row < n; row++)
+        {
+            if (num_fabs(matrix[row][col].hi) > num_fabs(matrix[pivot][col].hi))
+            {
+                pivot = row;
+            }
+        }
+
+        if (matrix[pivot][col].hi == 0.0)
+        {
+            return -1;
+        }
+
+        if (pivot != col)
+        {
+            for (size_t k = 0; k <= n; k++)
+            {
+                const dd_t swap = matrix[col][k];
+                matrix[col][k] = matrix[pivot][k];
+                matrix[pivot][k] = swap;
+            }
+        }
+
+        for (size_t row = col + 1; row < n; row++)
+        {
+            const dd_t factor = dd_div(matrix[row][col], matrix[col][col]);
+
+            for (size_t k = col; k <= n; k++)
+            {
+                matrix[row][k] = dd_sub(matrix[row][k], dd_mul(factor, matrix[col][k]));
+            }
+        }
+    }
+
+    dd_t solution[REMEZ_MAX_TERMS + 1];
+
+    for (size_t row = n; row-- > 0;)
+    {
+        dd_t sum = matrix[row][n];
+
+        for (size_t k = row + 1; k < n; k++)
+        {
+            sum = dd_sub(sum, dd_mul(matrix[row][k], solution[k]));
+        }
+
+        solution[row] = dd_div(sum, matrix[row][row]);
+    }
+
+    for (size_t i = 0; i < remez->terms; i++)
+    {
+        remez->coefficients[i] = solution[i];
+    }
+
+    remez->levelled_error = solution[n - 1];
+    return 0;
+}
+
+/**
+ * Maximizes sign * e(x) on [lo, hi] by golden-section search.
+ */
+static double remez_refine(const remez_t *remez, double lo, double hi, const double sign, double *peak)
+{
+    const double ratio = 0.61803398874989484820;
+    double x1 = hi - ratio * (hi - lo);
+    double x2 = lo + ratio * (hi - lo);
+    double e1 = sign * remez_error(remez, remez->coefficients, x1);
+    double e2 = sign * remez_error(remez, remez->coefficients, x2);
+
+    for (int step = 0; step < REMEZ_GOLDEN_STEPS && hi - lo > 1e-15 * num_fabs(hi); step++)
+    {
+        if (e1 > e2)
+        {
+            hi = x2;
+            x2 = x1;
+            e2 = e1;
+            x1 = hi - ratio * (hi - lo);
+            e1 = sign * remez_error(remez, remez->coefficients, x1);
+        }
+        else
+        {
+            lo = x1;
+            x1 = x2;
+            e1 = e2;
+            x2 = lo + ratio * (hi - lo);
+            e2 = sign * remez_error(remez, remez->coefficients, x2);
+        }
+    }
+
+    *peak = e1 > e2 ? e1 : e2;
+    return e1 > e2 ? x1 : x2;
+}
+
+/**
+ * Returns the i-th of count Chebyshev-distributed points on [a, b], ends included.
+ */
+static double remez_chebyshev_point(const double a, const double b, const size_t i, const size_t count)
+{
+    const double c = std_math_sinpi(0.5 - (double)i / (double)(count - 1)); // cos(pi * i / (count - 1))
+    return 0.5 * (a + b) - 0.5 * (b - a) * c;
+}
+
+/**
+ * Finds the alternating extrema of the error curve.
+ *
+ * Scans a dense grid, keeps the largest point of every run of equal sign,
+ * refines it, then drops end points until exactly `needed` remain.
+ *
+ * @return The number of extrema written to `reference`, below `needed` on failure.
+ */
+static size_t remez_extrema(const remez_t *remez, double *reference, const size_t needed, double *min_error,
+    double *max_error)
+{
+    const size_t grid = REMEZ_GRID_PER_POINT * needed;
+    double xs[4 * (REMEZ_MAX_TERMS + 1)];
+    double es[4 * (REMEZ_MAX_TERMS + 1)];
+    size_t runs = 0;
+    int run_sign = 0;
+
+    for (size_t g = 0; g < grid; g++)
+    {
+        const double x = remez_chebyshev_point(remez->a, remez->b, g, grid);
+        const double e = remez_error(remez, remez->coefficients, x);
+        const int sign = e > 0 ? 1 : e < 0 ? -1 : run_sign;
+
+        if (sign != run_sign || runs == 0)
+        {
+            if (runs == 4 * (REMEZ_MAX_TERMS + 1))
+            {
+                break;
+            }
+
+            run_sign = sign;
+            xs[runs] = x;
+            es[runs] = e;
+            runs++;
+        }
+        else if (num_fabs(e) > num_fabs(es[runs - 1]))
+        {
+            xs[runs - 1] = x;
+            es[runs - 1] = e;
+        }
+    }
+
+    // Polish each interior extremum between its grid neighbours
+    const double step = (remez->b - remez->a) * 4.0 / (double)grid;
+
+    for (size_t r = 0; r < runs; r++)
+    {
+        if (xs[r] == remez->a || xs[r] == remez->b)
+        {
+            continue;
+        }
+
+        const double lo = xs[r] - step < remez->a ? remez->a : xs[r] - step;
+        const double hi = xs[r] + step > remez->b ? remez->b : xs[r] + step;
+        const double sign = es[r] > 0 ? 1.0 : -1.0;
+        double peak;
+        const double x = remez_refine(remez, lo, hi, sign, &peak);
+
+        if (peak > num_fabs(es[r]))
+        {
+            xs[r] = x;
+            es[r] = sign * peak;
+        }
+    }
+
+    // Too many alternations: the smaller end contributes least
+    size_t first = 0;
+
+    while (runs - first > needed)
+    {
+        if (num_fabs(es[first]) < num_fabs(es[runs - 1]))
+        {
+            first++;
+        }
+        else
+        {
+            runs--;
+        }
+    }
+
+    *min_error = INFINITY;
+    *max_error = 0.0;
+
+    for (size_t r = first; r < runs; r++)
+    {
+        reference[r - first] = xs[r];
+        *min_error = num_fabs(es[r]) < *min_error ? num_fabs(es[r]) : *min_error;
+        *max_error = num_fabs(es[r]) > *max_error ? num_fabs(es[r]) : *max_error;
+    }
+
+    return runs - first;
+}
+
+/**
+ * Checks that f keeps one strict sign over the sampled interval.
+ */
+static int remez_sign_definite(const remez_t *remez)
+{
+    const size_t grid = REMEZ_GRID_PER_POINT * (remez->terms + 1);
+    const double first = remez->function(dd_from(remez->a)).hi;
+
+    for (size_t g = 0; g < grid; g++)
+    {
+        const double f = remez->function(dd_from(remez_chebyshev_point(remez->a, remez->b, g, grid))).hi;
+
+        if (f == 0.0 || (f > 0) != (first > 0))
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * Runs the exchange until the extrema are levelled.
+ *
+ * @return The number of iterations, or -1 if the solve failed.
+ */
+static int remez_run(remez_t *remez)
+{
+    const size_t needed = remez->terms + 1;
+    double reference[REMEZ_MAX_TERMS + 1];
+
+    for (size_t i = 0; i < needed; i++)
+    {
+        reference[i] = remez_chebyshev_point(remez->a, remez->b, i, needed);
+    }
+
+    for (int iteration = 1; iteration <= REMEZ_MAX_ITERATIONS; iteration++)
+    {
+        double min_error;
+        double max_error;
+
+        if (remez_solve(remez, reference) != 0)
+        {
+            return -1;
+        }
+
+        if (remez_extrema(remez, reference, needed, &min_error, &max_error) < needed)
+        {
+            fprintf(stderr, "std_math_remez: error curve lost its alternation, keeping iteration %d\n", iteration);
+            return iteration;
+        }
+
+        if (max_error <= min_error * (1.0 + 1e-6))
+        {
+            return iteration;
+        }
+    }
+
+    fprintf(stderr, "std_math_remez: not levelled after %d iterations\n", REMEZ_MAX_ITERATIONS);
+    return REMEZ_MAX_ITERATIONS;
+}
+
+/**
+ * Measures the largest weighted error of the double-rounded coefficients.
+ */
+static double remez_measure(const remez_t *remez, const double *rounded)
+{
+    dd_t coefficients[REMEZ_MAX_TERMS];
+    const size_t grid = 4 * REMEZ_GRID_PER_POINT * (remez->terms + 1);
+    double worst = 0.0;
+
+    for (size_t i = 0; i < remez->terms; i++)
+    {
+        coefficients[i] = dd_from(rounded[i]);
+    }
+
+    for (size_t g = 0; g < grid; g++)
+    {
+        const double e = num_fabs(remez_error(remez, coefficients, remez_chebyshev_point(remez->a, remez->b, g, grid)));
+
+        // Written so that a NaN error wins and is reported, not skipped
+        worst = e <= worst ? worst : e;
+    }
+
+    return worst;
+}
+
+// ============= HEADER OUTPUT =============
+static void remez_write_header(FILE *out, const remez_t *remez, const char *function, const char *name,
+    const double *rounded, const double measured, const int iterations)
+{
+    char macro[128];
+    size_t length = 0;
+
+    for (; name[length] && length + 1 < sizeof(macro); length++)
+    {
+        macro[length] = (char)toupper((unsigned char)name[length]);
+    }
+
+    macro[length] = '\0';
+
+    const char *shape = remez->symmetry == REMEZ_ODD ? "odd" : remez->symmetry == REMEZ_EVEN ? "even" : "full";
+    const size_t degree = remez->symmetry == REMEZ_ODD ? 2 * remez->terms - 1
+        : remez->symmetry == REMEZ_EVEN ? 2 * (remez->terms - 1) : remez->terms - 1;
+
+    fprintf(out, "/*\n");
+    fprintf(out, " * Generated by std_math_remez, do not edit.\n");
+    fprintf(out, " *\n");
+    fprintf(out, " * Minimax %s polynomial of degree %zu for %s on [%.17g, %.17g],\n", shape, degree, function,
+        remez->requested_a, remez->b);
+    fprintf(out, " * %s error, levelled in %d Remez iterations.\n", remez->relative ? "relative" : "absolute",
+        iterations);
+    fprintf(out, " * Levelled error (exact coefficients): %.3e\n", num_fabs(dd_to_double(remez->levelled_error)));
+    fprintf(out, " * Measured error (double coefficients): %.3e\n", measured);
+    fprintf(out, " *\n");
+
+    if (remez->symmetry == REMEZ_ODD)
+    {
+        fprintf(out, " * Evaluate as x * num_poly_horner(%s, %s_DEGREE, x * x).\n", name, macro);
+    }
+    else if (remez->symmetry == REMEZ_EVEN)
+    {
+        fprintf(out, " * Evaluate as num_poly_horner(%s, %s_DEGREE, x * x).\n", name, macro);
+    }
+    else
+    {
+        fprintf(out, " * Evaluate as num_poly_horner(%s, %s_DEGREE, x).\n", name, macro);
+    }
+
+    fprintf(out, "*/\n");
+    fprintf(out, "#ifndef %s_H\n", macro);
+    fprintf(out, "#define %s_H\n\n", macro);
+    fprintf(out, "#define %s_DEGREE %zu\n", macro, remez->terms - 1);
+    fprintf(out, "#define %s_ERROR %.6e\n\n", macro, measured);
+    fprintf(out, "static const double %s[%zu] = {\n", name, remez->terms);
+
+    for (size_t i = 0; i < remez->terms; i++)
+    {
+        fprintf(out, "    %.20e,\n", rounded[i]);
+    }
+
+    fprintf(out, "};\n\n");
+    fprintf(out, "#endif //%s_H\n", macro);
+}
+
+// ============= COMMAND LINE =============
+static int remez_usage(void)
+{
+    fprintf(stderr,
+        "usage: std_math_remez <function> <a> <b> <degree> [--relative] [--odd | --even]\n"
+        "                      [--name NAME] [--output FILE]\n"
+        "functions: sin, cos, exp, expm1, log, log1p\n");
+    return 2;
+}
+
+/**
+ * Parses a whole argument as a double.
+ *
+ * @return 0 on success, -1 if any of the text is not part of a number.
+ */
+static int remez_parse_double(const char *text, double *value)
+{
+    char *end;
+
+    *value = strtod(text, &end);
+
+    if (end == text || *end != '\0')
+    {
+        fprintf(stderr, "std_math_remez: '%s' is not a number\n", text);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * Parses a whole argument as a decimal integer.
+ *
+ * @return 0 on success, -1 if any of the text is not part of an integer.
+ */
+static int remez_parse_long(const char *text, long *value)
+{
+    char *end;
+
+    *value = strtol(text, &end, 10);
+
+    if (end == text || *end != '\0')
+    {
+        fprintf(stderr, "std_math_remez: '%s' is not an integer\n", text);
+        return -1;
+    }
+
+    return 0;
+}
+
+int main(const int argc, char **argv)
+{
+    if (argc < 5)
+    {
+        return remez_usage();
+    }
+
+    remez_t remez;
+    const char *name = "remez_coefficients";
+    const remez_function_t *function = NULL;
+    const char *output = NULL;
+
+    memset(&remez, 0, sizeof(remez));
+
+    for (size_t i = 0; i < sizeof(remez_functions) / sizeof(remez_functions[0]); i++)
+    {
+        if (strcmp(argv[1], remez_functions[i].name) == 0)
+        {
+            function = &remez_functions[i];
+        }
+    }
+
+    if (!function)
+    {
+        fprintf(stderr, "std_math_remez: unknown function '%s'\n", argv[1]);
+        return remez_usage();
+    }
+
+    long degree;
+
+    remez.function = function->function;
+
+    if (remez_parse_double(argv[2], &remez.a) || remez_parse_double(argv[3], &remez.b)
+        || remez_parse_long(argv[4], &degree))
+    {
+        return remez_usage();
+    }
+
+    for (int i = 5; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--relative") == 0)
+        {
+            remez.relative = 1;
+        }
+        else if (strcmp(argv[i], "--odd") == 0)
+        {
+            remez.symmetry = REMEZ_ODD;
+        }
+        else if (strcmp(argv[i], "--even") == 0)
+        {
+            remez.symmetry = REMEZ_EVEN;
+        }
+        else if (strcmp(argv[i], "--name") == 0 && i + 1 < argc)
+        {
+            name = argv[++i];
+        }
+        else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+        {
+            output = argv[++i];
+        }
+        else
+        {
+            return remez_usage();
+        }
+    }
+
+    // Odd and even fits count terms, full fits count the degree
+    const long terms = remez.symmetry == REMEZ_FULL ? degree + 1 : degree;
+
+    if (!(remez.a < remez.b) || terms < 1 || terms > REMEZ_MAX_TERMS)
+    {
+        fprintf(stderr, "std_math_remez: need a < b and 1 to %d coefficients\n", REMEZ_MAX_TERMS);
+        return 2;
+    }
+
+    if (!(remez.a > function->above) || !(remez.b <= function->upper))
+    {
+        fprintf(stderr, "std_math_remez: %s needs %s\n", function->name, function->domain);
+        return 2;
+    }
+
+    if (remez.symmetry != REMEZ_FULL && remez.a < 0.0)
+    {
+        fprintf(stderr, "std_math_remez: --odd and --even fit [a, b] with a >= 0, the mirror half is implied\n");
+        return 2;
+    }
+
+    remez.terms = (size_t)terms;
+    remez.requested_a = remez.a;
+
+    // A zero of f at the left end makes the relative error 0/0 and pins an
+    // odd fit's error to zero there; the curve is flat next to it, so
+    // sampling from a tiny offset loses nothing
+    if (remez.a == 0.0 && (remez.symmetry == REMEZ_ODD || remez.function(dd_from(0.0)).hi == 0.0))
+    {
+        remez.a = num_ldexp(remez.b, -26);
+    }
+
+    if (remez.relative && !remez_sign_definite(&remez))
+    {
+        fprintf(stderr, "std_math_remez: --relative needs f free of zeros on [a, b]; fit f(x) / x^k instead\n");
+        return 2;
+    }
+
+    const int iterations = remez_run(&remez);
+
+    if (iterations < 0)
+    {
+        fprintf(stderr, "std_math_remez: singular system, try a lower degree or a wider interval\n");
+        return 1;
+    }
+
+    double rounded[REMEZ_MAX_TERMS];
+
+    for (size_t i = 0; i < remez.terms; i++)
+    {
+        rounded[i] = dd_to_double(remez.coefficients[i]);
+    }
+
+    const double measured = remez_measure(&remez, rounded);
+    const double levelled = dd_to_double(remez.levelled_error);
+
+    // A NaN or infinite E means the solve broke down; writing it out would
+    // publish a header whose error bound reads as zero
+    if (levelled - levelled != 0.0 || measured - measured != 0.0)
+    {
+        fprintf(stderr, "std_math_remez: error is not finite (levelled %g, measured %g), no header written\n",
+            levelled, measured);
+        return 1;
+    }
+
+    FILE *out = output ? fopen(output, "w") : stdout;
+
+    if (!out)
+    {
+        fprintf(stderr, "std_math_remez: cannot open '%s'\n", output);
+        return 1;
+    }
+
+    remez_write_header(out, &remez, argv[1], name, rounded, measured, iterations);
+
+    if (output)
+    {
+        fclose(out);
+    }
+
+    return 0;
+}
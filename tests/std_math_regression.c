@@ -0,0 +1,723 @@
+/*
+ * This code is distributed under the terms of the GNU General Public License.
+ * For more information, please refer to the LICENSE file in the root directory.
+ * -------------------------------------------------
+ * Copyright (C) 2025 Rodrigo R.
+ * This program comes with ABSOLUTELY NO WARRANTY; for details type `show w`.
+ * This is free software, and you are welcome to redistribute it
+ * under certain conditions; type `show c` for details.
+*/
+
+// ============= FLUENT LIB C =============
+// Regression Checks
+// ----------------------------------------
+// Reproduces numerical bugs found in review so they stay fixed. Each check
+// compares against values exact by construction (closed forms evaluated in
+// double, or constants quoted to 17 digits), so no libm is linked.
+//
+// Run through `ctest`, or directly; the exit code is the number of failures.
+
+#include <stdio.h>
+
+#include "../std_math.h"
+
+static int failures = 0;
+
+/**
+ * Reports a failed check.
+ *
+ * @param condition The check; nonzero passes.
+ * @param what What was checked, printed on failure.
+ */
+static void check(const int condition, const char *what)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+/**
+ * Returns |x - reference| / |reference|.
+ */
+static double relative_error(const double x, const double reference)
+{
+    return num_fabs(x - reference) / num_fabs(reference);
+}
+
+// ============= GAMMA FUNCTION =============
+/**
+ * num_tgamma returned exp(lgamma(x)), whose rounding near ln Gamma = 700
+ * came out as ~3e-13 relative, and the reflection formula rounded 1 - x.
+ * The product recurrence that replaced it still lost ~2e-15 over up to 170
+ * factors; large arguments now take the Stirling series directly.
+ * Half-integers have closed forms: Gamma(n + 1/2) = (2n)! sqrt(pi) / (4^n n!).
+ */
+static void check_gamma(void)
+{
+    check(relative_error(num_tgamma(167.5), 1.16266281095454938e+299) < 1e-15, "num_tgamma(167.5)");
+    check(relative_error(num_tgamma(100.5), 9.32096310408271621e+156) < 1e-15, "num_tgamma(100.5)");
+    check(relative_error(num_tgamma(1.5), 8.86226925452758052e-01) < 5e-15, "num_tgamma(1.5)");
+    check(relative_error(num_tgamma(-127.5), 9.22611531826885061e-215) < 1e-15, "num_tgamma(-127.5)");
+    check(relative_error(num_tgamma(-170.5), -3.31273952153860742e-308) < 1e-15, "num_tgamma(-170.5)");
+}
+
+// ============= BIGINT =============
+/**
+ * bigint_to_string returned early on a short buffer without releasing its
+ * temporaries, so every failed call leaked arena space.
+ */
+static void check_bigint(void)
+{
+    static double memory[256];
+    num_arena_t arena;
+    bigint_t x;
+    char text[8];
+
+    num_arena_init(&arena, memory, sizeof(memory));
+
+    if (bigint_init(&x, 4, &arena) || bigint_from_string(&x, "-123456789012345678901234567890"))
+    {
+        check(0, "bigint: setup");
+        return;
+    }
+
+    const size_t used = arena.used;
+
+    check(bigint_to_string(&x, text, sizeof(text), &arena) == -1 && arena.used == used,
+        "bigint: bigint_to_string releases its temporaries on a short buffer");
+    check(bigint_to_string(&x, text, 1, &arena) == -1 && arena.used == used,
+        "bigint: bigint_to_string releases its temporaries without room for the sign");
+}
+
+// ============= BIG FACTORIALS =============
+/**
+ * bigint_factorial and its binary-splitting helpers released the arena
+ * only on success, so a factorial that ran out partway kept everything
+ * it had taken.
+ */
+static void check_factorial(void)
+{
+    static double scratch[4096];
+    num_arena_t arena;
+    bigint_t result;
+    int failed = 0;
+    int released = 1;
+    int succeeded = 0;
+
+    for (size_t bytes = 0; bytes <= sizeof(scratch) && !succeeded; bytes += 16)
+    {
+        num_arena_init(&arena, scratch, bytes);
+
+        if (bigint_factorial(&result, 300, &arena) == 0)
+        {
+            succeeded = 1;
+        }
+        else
+        {
+            failed = 1;
+            released = released && arena.used == 0;
+        }
+    }
+
+    check(failed && succeeded && released, "factorial: arena unchanged after exhaustion");
+}
+
+// ============= NTT =============
+/**
+ * The NTT products returned -1 on a failed allocation without releasing
+ * what they had already taken from the arena.
+ */
+static void check_ntt(void)
+{
+    static double scratch[1024];
+    uint32_t a[40];
+    uint32_t b[40];
+    uint64_t out[79];
+    num_arena_t arena;
+    int failed = 0;
+    int released = 1;
+    int succeeded = 0;
+
+    for (size_t i = 0; i < 40; i++)
+    {
+        a[i] = (uint32_t)(2654435761u * (i + 1));
+        b[i] = (uint32_t)(40503u * (i + 7));
+    }
+
+    for (size_t bytes = 0; bytes <= sizeof(scratch) && !succeeded; bytes += 16)
+    {
+        num_arena_init(&arena, scratch, bytes);
+
+        if (num_ntt_poly_mul(out, a, 40, b, 40, &arena) == 0)
+        {
+            succeeded = 1;
+        }
+        else
+        {
+            failed = 1;
+        }
+
+        released = released && arena.used == 0;
+    }
+
+    check(failed && succeeded && released, "ntt: temporaries released on arena exhaustion");
+}
+
+// ============= MODULAR EXPONENTIATION =============
+/**
+ * bigint_powmod released its temporaries only on success, so every call
+ * that ran out of arena partway through kept what it had taken.
+ */
+static void check_powmod(void)
+{
+    static double memory[256];
+    static double scratch[512];
+    const char *moduli[2] = { "1000000000000000000000000000057", "1000000000000000000000000000058" };
+    num_arena_t arena;
+    num_arena_t temporaries;
+    bigint_t base;
+    bigint_t exponent;
+    bigint_t modulus;
+    bigint_t out;
+
+    for (int m = 0; m < 2; m++)
+    {
+        int failed = 0;
+        int released = 1;
+        int succeeded = 0;
+
+        num_arena_init(&arena, memory, sizeof(memory));
+
+        if (bigint_init(&base, 4, &arena) || bigint_init(&exponent, 4, &arena) || bigint_init(&modulus, 4, &arena)
+            || bigint_init(&out, 4, &arena) || bigint_from_string(&base, "123456789123456789")
+            || bigint_from_string(&exponent, "987654321987654321") || bigint_from_string(&modulus, moduli[m]))
+        {
+            check(0, "powmod: setup");
+            return;
+        }
+
+        // Every arena size from nothing up to enough fails cleanly or succeeds
+        for (size_t bytes = 0; bytes <= sizeof(scratch) && !succeeded; bytes += 16)
+        {
+            num_arena_init(&temporaries, scratch, bytes);
+
+            if (bigint_powmod(&out, &base, &exponent, &modulus, &temporaries) == 0)
+            {
+                succeeded = 1;
+            }
+            else
+            {
+                failed = 1;
+            }
+
+            released = released && temporaries.used == 0;
+        }
+
+        check(failed && succeeded && released, "powmod: temporaries released on arena exhaustion");
+    }
+}
+
+// ============= NORMAL DISTRIBUTION =============
+/**
+ * The Halley step of num_norminv evaluated exp(x^2 / 2), which overflows
+ * for subnormal p and turned valid inputs into NaN. The batch versions
+ * were scalar loops until they got vector kernels of their own.
+ */
+static void check_normal(void)
+{
+    check(relative_error(num_norminv(1e-311), -37.724104354320736) < 1e-15, "num_norminv(1e-311)");
+    check(relative_error(num_norminv(4.9406564584124654e-324), -38.467405617144346) < 1e-8,
+        "num_norminv(smallest subnormal)");
+    check(relative_error(num_norminv(1.0 - 1e-16), 8.2095361516013869) < 1e-15, "num_norminv(1 - 1e-16)");
+
+    // The batch kernels blend every piece per lane; each lane must still
+    // match the scalar function, edges and specials included
+    static const double x[12] = {NAN, -INFINITY, -30.0, -6.0, -1.25, -0.84375, -0.0, 0.2, 1.0, 2.9, 27.0, INFINITY};
+    static const double p[12] = {NAN, -0.5, 0.0, 4.9406564584124654e-324, 1e-300, 0.02, 0.3, 0.5, 0.97, 0.99, 1.0, 2.0};
+    double out[4][12];
+    int agree = 1;
+
+    num_erf_batch(x, out[0], 12);
+    num_erfc_batch(x, out[1], 12);
+    num_normcdf_batch(x, out[2], 12);
+    num_norminv_batch(p, out[3], 12);
+
+    for (size_t i = 0; i < 12; i++)
+    {
+        const double reference[4] = {num_erf(x[i]), num_erfc(x[i]), num_normcdf(x[i]), num_norminv(p[i])};
+
+        for (size_t f = 0; f < 4; f++)
+        {
+            const double got = out[f][i];
+            const double want = reference[f];
+
+            agree &= want != want ? got != got : got == want || relative_error(got, want) < 4e-16;
+        }
+    }
+
+    check(agree, "erf, erfc, normcdf and norminv batches match the scalar functions");
+}
+
+// ============= PRIME SIEVE =============
+/**
+ * Segments smaller than the wheel primes used to leave 3 to 13 struck out
+ * when they fell outside the first segment, and a one-byte first segment
+ * missed 2.
+ */
+static void check_sieve(void)
+{
+    static double memory[4096];
+    unsigned char scratch[16];
+
+    for (size_t bytes = 1; bytes <= sizeof(scratch); bytes++)
+    {
+        num_arena_t arena;
+        num_sieve_t sieve;
+        size_t count = 0;
+
+        num_arena_init(&arena, memory, sizeof(memory));
+
+        if (num_sieve_init(&sieve, 5000, bytes, &arena))
+        {
+            check(0, "sieve: arena");
+            return;
+        }
+
+        for (size_t i = 0; i < num_sieve_segment_count(&sieve); i++)
+        {
+            count += num_sieve_segment(&sieve, i, scratch, NULL, 0);
+        }
+
+        check(count == 669, "sieve: pi(5000) with small segments");
+    }
+}
+
+// ============= BINOMIAL COEFFICIENTS =============
+/**
+ * Stirling's form of lbinomial formed n - k in double, which drops k once
+ * n reaches 2^53, and cancelled in (n - k) log(n / (n - k)).
+ */
+static void check_binomial(void)
+{
+    check(relative_error(lbinomial(1ULL << 60, 65), 2493.9314174312499) < 1e-14, "lbinomial(2^60, 65)");
+    check(relative_error(lbinomial(UINT64_MAX, 1000), 38449.291377348336) < 1e-14, "lbinomial(2^64 - 1, 1000)");
+    check(relative_error(lbinomial(1ULL << 40, 1000), 21813.759043455356) < 1e-14, "lbinomial(2^40, 1000)");
+}
+
+// ============= POWER SERIES =============
+static double series_memory[1 << 23];
+
+/**
+ * Newton iteration above NUM_POWER_SERIES_NTT_THRESHOLD must agree with
+ * the recurrences below it; it used to overwrite the low coefficients with
+ * NTT products whose digits were set by rescaled rounding noise.
+ */
+static void check_power_series(void)
+{
+    const size_t orders[2] = {2 * NUM_POWER_SERIES_NTT_THRESHOLD + 1, 4 * NUM_POWER_SERIES_NTT_THRESHOLD + 1};
+    num_arena_t arena;
+
+    for (size_t o = 0; o < 2; o++)
+    {
+        const size_t n = orders[o];
+        num_power_series_t a;
+        num_power_series_t g;
+        num_power_series_t h;
+        double worst[4] = {0, 0, 0, 0};
+
+        num_arena_init(&arena, series_memory, sizeof(series_memory));
+
+        if (num_power_series_init(&a, n, &arena) || num_power_series_init(&g, n, &arena)
+            || num_power_series_init(&h, n, &arena))
+        {
+            check(0, "power series: arena");
+            return;
+        }
+
+        // 1 / (1 - 0.999 x) = sum 0.999^k x^k
+        a.coefficients[0] = 1;
+        a.coefficients[1] = -0.999;
+        check(num_power_series_inverse(&g, &a, &arena) == 0, "power series: inverse status");
+
+        double reference = 1;
+
+        for (size_t k = 0; k < n; k++, reference *= 0.999)
+        {
+            const double e = relative_error(g.coefficients[k], reference);
+            worst[0] = e > worst[0] ? e : worst[0];
+        }
+
+        // sqrt(1 - 0.999 x), with g_k = g_(k-1) * 0.999 (k - 3/2) / k
+        check(num_power_series_sqrt(&g, &a, &arena) == 0, "power series: sqrt status");
+        reference = 1;
+
+        for (size_t k = 0; k < n; k++)
+        {
+            reference *= k ? 0.999 * ((double)k - 1.5) / (double)k : 1.0;
+
+            const double e = relative_error(g.coefficients[k], reference);
+            worst[1] = e > worst[1] ? e : worst[1];
+        }
+
+        // exp(-log(1 - 0.999 x)) = 1 / (1 - 0.999 x), and back through log
+        double power = 1;
+
+        a.coefficients[0] = 0;
+
+        for (size_t k = 1; k < n; k++)
+        {
+            power *= 0.999;
+            a.coefficients[k] = power / (double)k;
+        }
+
+        check(num_power_series_exp(&g, &a, &arena) == 0, "power series: exp status");
+        check(num_power_series_log(&h, &g, &arena) == 0, "power series: log status");
+        reference = 1;
+
+        for (size_t k = 0; k < n; k++, reference *= 0.999)
+        {
+            const double e = relative_error(g.coefficients[k], reference);
+            const double l = k ? relative_error(h.coefficients[k], a.coefficients[k]) : num_fabs(h.coefficients[0]);
+
+            worst[2] = e > worst[2] ? e : worst[2];
+            worst[3] = l > worst[3] ? l : worst[3];
+        }
+
+        check(worst[0] < 1e-11, "power series: 1 / (1 - 0.999 x) above the NTT threshold");
+        check(worst[1] < 1e-10, "power series: sqrt(1 - 0.999 x) above the NTT threshold");
+        check(worst[2] < 1e-11, "power series: exp above the NTT threshold");
+
+        // g' / g cancels by a factor k in coefficient k, on either side of the threshold
+        check(worst[3] < 1e-9, "power series: log above the NTT threshold");
+
+        // exp(x) keeps g_0 = 1 and 1 / 20! however far the order goes
+        for (size_t k = 0; k < n; k++)
+        {
+            a.coefficients[k] = k == 1;
+        }
+
+        check(num_power_series_exp(&g, &a, &arena) == 0 && g.coefficients[0] == 1.0
+            && relative_error(g.coefficients[20], 4.1103176233121648e-19) < 1e-14, "power series: exp(x)");
+    }
+
+    // Coefficients decaying at different rates leave the NTT digit range;
+    // the product must still be accurate coefficient by coefficient
+    const size_t n = 4 * NUM_POWER_SERIES_NTT_THRESHOLD;
+    num_power_series_t a;
+    num_power_series_t b;
+    num_power_series_t c;
+    double worst = 0;
+
+    num_arena_init(&arena, series_memory, sizeof(series_memory));
+    num_power_series_init(&a, n, &arena);
+    num_power_series_init(&b, n, &arena);
+    num_power_series_init(&c, n, &arena);
+    a.coefficients[0] = 1;
+    b.coefficients[0] = 1;
+
+    for (size_t k = 1; k < n; k++)
+    {
+        a.coefficients[k] = a.coefficients[k - 1] * 0.9;
+        b.coefficients[k] = b.coefficients[k - 1] * 1.01;
+    }
+
+    check(num_power_series_mul(&c, &a, &b, &arena) == 0, "power series: mul status");
+
+    // c_k = 1.01 c_(k-1) + 0.9^k
+    double reference = 0;
+
+    for (size_t k = 0; k < n; k++)
+    {
+        reference = 1.01 * reference + a.coefficients[k];
+
+        const double e = relative_error(c.coefficients[k], reference);
+        worst = e > worst ? e : worst;
+    }
+
+    check(worst < 1e-12, "power series: product of 0.9^k and 1.01^k");
+}
+
+// ============= PADE APPROXIMANTS =============
+/**
+ * num_pade_best accepted [10/9] for log1p on [-0.9, 0.9] at 1e-8 on its
+ * residual estimate of 9.6e-9, while the true error at -0.9 is 1.25e-5.
+ */
+static void check_pade(void)
+{
+    static double memory[8192];
+    double series[60];
+    num_arena_t arena;
+    num_pade_t pade;
+
+    num_arena_init(&arena, memory, sizeof(memory));
+    series[0] = 0;
+
+    for (size_t k = 1; k < 60; k++)
+    {
+        series[k] = (k & 1 ? 1.0 : -1.0) / (double)k;
+    }
+
+    for (size_t terms = 24; terms <= 60; terms += 12)
+    {
+        double worst = 0;
+
+        if (num_pade_best(&pade, series, terms, 0.9, 1e-8, &arena) != 0)
+        {
+            continue;
+        }
+
+        for (int i = -900; i <= 900; i++)
+        {
+            const double x = (double)i / 1000.0;
+            const double e = num_fabs(num_pade_eval(&pade, x) - std_math_log1p(x));
+            worst = e > worst ? e : worst;
+        }
+
+        check(worst <= 1e-8, "pade: log1p on [-0.9, 0.9] meets its tolerance");
+    }
+}
+
+// ============= CHEBYSHEV APPROXIMANTS =============
+/**
+ * |x|, with its kink at 0.
+ */
+static double abs_value(const double x, void *context)
+{
+    (void)context;
+    return num_fabs(x);
+}
+
+/**
+ * num_chebyshev_fit halved every piece at once, so the kink of |x| on
+ * [-1, 2] stayed inside a piece as wide as the smooth ones and 1e-10 was
+ * out of reach even with 1024 pieces.
+ */
+static void check_chebyshev(void)
+{
+    static double memory[16384];
+    num_arena_t arena;
+    num_chebyshev_t cheb;
+    double worst = 0;
+
+    num_arena_init(&arena, memory, sizeof(memory));
+
+    if (num_chebyshev_fit(&cheb, abs_value, NULL, -1.0, 2.0, 1e-10, 64, &arena) != 0)
+    {
+        check(0, "chebyshev: |x| on [-1, 2] fits in 64 pieces");
+        return;
+    }
+
+    for (int i = -30000; i <= 60000; i++)
+    {
+        const double x = (double)i / 30000.0;
+        const double e = num_fabs(num_chebyshev_eval(&cheb, x) - num_fabs(x));
+        worst = e > worst ? e : worst;
+    }
+
+    check(worst <= 2e-10, "chebyshev: |x| on [-1, 2] near its tolerance");
+}
+
+// ============= FIXED-POINT ARITHMETIC =============
+/**
+ * The fixed-point section stopped at Q15/Q16.16 trig and exp: Q31 had no
+ * sin/cos/atan2/exp and Q32.32 none of the five. These pin the new kernels
+ * to their documented bounds, including the saturation at -1 and +1.
+ */
+static void check_fixed_point(void)
+{
+    const double q32 = 4294967296.0;
+
+    check(num_fabs(num_q31_sin(1 << 29) - 1518500249.988025) <= 2.0, "fixed: q31 sin(pi/4)");
+    check(num_fabs(num_q31_cos(-(1 << 29)) - 1518500249.988025) <= 2.0, "fixed: q31 cos(-pi/4)");
+    check(num_q31_sin(1 << 30) == 2147483647, "fixed: q31 sin(pi/2) saturates");
+    check(num_q31_sin(-(1 << 30)) == -2147483647 - 1, "fixed: q31 sin(-pi/2) is -1");
+    check(num_q31_atan2(1000, 1000) >= 536870909 && num_q31_atan2(1000, 1000) <= 536870915, "fixed: q31 atan2(1, 1)");
+    check(num_q31_atan2(-2147483647 - 1, -2147483647 - 1) >= -1610612739
+        && num_q31_atan2(-2147483647 - 1, -2147483647 - 1) <= -1610612733, "fixed: q31 atan2(-1, -1)");
+    check(num_q31_atan2(0, -7) == 2147483647, "fixed: q31 atan2(0, -1) saturates");
+    check(num_fabs(num_q31_exp(-(1 << 30)) - 1302514673.7435327) <= 2.0, "fixed: q31 exp(-0.5)");
+    check(num_fabs(num_q31_exp(-2147483647 - 1) - 790015084.3510504) <= 2.0, "fixed: q31 exp(-1)");
+    check(num_q31_exp(0) == 2147483647, "fixed: q31 exp(0) saturates");
+
+    check(num_fabs(num_q32_32_sin(2248839617LL) / q32 - 0.5) <= 1e-9, "fixed: q32.32 sin(pi/6)");
+    check(num_fabs(num_q32_32_sin(1000 * NUM_Q32_32_ONE) / q32 - 0.8268795405320025) <= 1e-9, "fixed: q32.32 sin(1000)");
+    check(num_fabs(num_q32_32_cos(-1000 * NUM_Q32_32_ONE) / q32 - 0.5623790762907029) <= 1e-9, "fixed: q32.32 cos(-1000)");
+    check(num_fabs(num_q32_32_atan2(NUM_Q32_32_ONE, NUM_Q32_32_ONE) / q32 - 0.78539816339744831) <= 4e-9, "fixed: q32.32 atan2(1, 1)");
+    check(num_fabs(num_q32_32_atan2(-3 * NUM_Q32_32_ONE, -3 * NUM_Q32_32_ONE) / q32 + 2.3561944901923449) <= 4e-9,
+        "fixed: q32.32 atan2(-3, -3)");
+    check(num_fabs(num_q32_32_atan2(9223372036854775807LL, 1) / q32 - 1.5707963267948966) <= 4e-9, "fixed: q32.32 atan2(huge, tiny)");
+    check(num_q32_32_sqrt(2 * NUM_Q32_32_ONE) == 6074000999LL, "fixed: q32.32 sqrt(2) truncates");
+    check(num_q32_32_sqrt(9223372036854775807LL) == 199032864766430LL, "fixed: q32.32 sqrt of the largest value");
+    check(relative_error(num_q32_32_exp(10 * NUM_Q32_32_ONE) / q32, 22026.465794806718) <= 1e-9, "fixed: q32.32 exp(10)");
+    check(num_fabs(num_q32_32_exp(-20 * NUM_Q32_32_ONE) - 8.852587400405538) <= 1.0, "fixed: q32.32 exp(-20)");
+    check(num_q32_32_exp(21 * NUM_Q32_32_ONE + NUM_Q32_32_ONE / 2) == 9223372036854775807LL, "fixed: q32.32 exp(21.5) saturates");
+    check(num_q32_32_exp(-23 * NUM_Q32_32_ONE) == 0, "fixed: q32.32 exp(-23) is 0");
+
+    check(num_q15_atan2(100, 100) == 8192, "fixed: q15 atan2(1, 1)");
+    check(num_fabs(num_q15_exp(-16384) - 19874.796657463572) <= 1.0, "fixed: q15 exp(-0.5)");
+    check(num_q15_exp(0) == 32767, "fixed: q15 exp(0) saturates");
+}
+
+// ============= CORDIC =============
+/**
+ * num_cordic_sincos reduced by pi with a split constant exact only up to
+ * about 3.29e6, so sincos(1e300) came back as finite garbage.
+ */
+static void check_cordic(void)
+{
+    const double in[6] = { 1e300, -4e6, INFINITY, NAN, 3e6, -0.5 };
+    double sines[6];
+    double cosines[6];
+    double sine;
+    double cosine;
+
+    num_cordic_sincos(1e300, 53, &sine, &cosine);
+    check(num_isnan(sine) && num_isnan(cosine), "cordic: sincos(1e300) is NaN");
+
+    num_cordic_rotate(1.0, 0.0, -1e10, 53, &sine, &cosine);
+    check(num_isnan(sine) && num_isnan(cosine), "cordic: rotation by -1e10 is NaN");
+
+    num_cordic_sincos_batch(in, sines, cosines, 6, 53);
+
+    for (size_t i = 0; i < 6; i++)
+    {
+        num_cordic_sincos(in[i], 53, &sine, &cosine);
+
+        const int same_sine = num_isnan(sine) ? num_isnan(sines[i]) : sines[i] == sine;
+        const int same_cosine = num_isnan(cosine) ? num_isnan(cosines[i]) : cosines[i] == cosine;
+        check(same_sine && same_cosine, "cordic: batch matches scalar, NaN out of range");
+    }
+}
+
+// ============= LOOKUP-TABLE TRIGONOMETRY =============
+/**
+ * num_trig_table_sin floors x * scale with the 1.5 * 2^52 rounder, which
+ * stops working at 2^51 and silently picked the wrong sample.
+ */
+static void check_trig_table(void)
+{
+    static double memory[512];
+    const double in[5] = { 1e300, -1e20, INFINITY, 1e6, -0.5 };
+    double out[5];
+    num_arena_t arena;
+    num_trig_table_t table;
+
+    num_arena_init(&arena, memory, sizeof(memory));
+
+    if (num_trig_table_init(&table, 256, NUM_TRIG_TABLE_CUBIC, &arena) != 0)
+    {
+        check(0, "trig table: 256 entries fit");
+        return;
+    }
+
+    check(num_isnan(num_trig_table_sin(&table, 1e300)), "trig table: sin(1e300) is NaN");
+    check(num_isnan(num_trig_table_cos(&table, -1e20)), "trig table: cos(-1e20) is NaN");
+
+    num_trig_table_sin_batch(&table, in, out, 5);
+
+    for (size_t i = 0; i < 5; i++)
+    {
+        const double scalar = num_trig_table_sin(&table, in[i]);
+        check(num_isnan(scalar) ? num_isnan(out[i]) : out[i] == scalar, "trig table: batch matches scalar, NaN out of range");
+    }
+}
+
+// ============= SERIES PLANS =============
+/**
+ * num_series_plan_eval reduced sin and cos with the same split pi as
+ * CORDIC and returned finite garbage past about 3.29e6.
+ */
+static void check_series_plan(void)
+{
+    static double memory[256];
+    num_arena_t arena;
+    num_series_plan_t plan;
+
+    num_arena_init(&arena, memory, sizeof(memory));
+
+    if (num_series_plan_init(&plan, NUM_SERIES_SIN, 12, NUM_SERIES_HORNER, &arena) != 0)
+    {
+        check(0, "series plan: sin with 12 terms fits");
+        return;
+    }
+
+    check(num_isnan(num_series_plan_eval(&plan, 1e300)), "series plan: sin(1e300) is NaN");
+    check(relative_error(num_series_plan_eval(&plan, 0.5), 0.47942553860420301) < 1e-15, "series plan: sin(0.5)");
+}
+
+// ============= SERIES ACCELERATION =============
+/**
+ * Terms of a zero series.
+ */
+static double zero_term(const size_t n, void *context)
+{
+    (void)n;
+    (void)context;
+    return 0.0;
+}
+
+/**
+ * Terms of 1 + 2 + 1/2, then zeros.
+ */
+static double finite_term(const size_t n, void *context)
+{
+    (void)context;
+    return n == 0 ? 1.0 : n == 1 ? 2.0 : n == 2 ? 0.5 : 0.0;
+}
+
+/**
+ * Terms of sum 2^-n = 2.
+ */
+static double halving_term(const size_t n, void *context)
+{
+    (void)context;
+    return num_ldexp(1.0, -(int)n);
+}
+
+/**
+ * Wynn's epsilon table divides by differences that vanish once a sum is
+ * reached exactly; its 1e300 stand-in for the infinite entry used to come
+ * back as the sum itself.
+ */
+static void check_series_acceleration(void)
+{
+    num_series_sum_t sum;
+
+    num_series_wynn(finite_term, NULL, 1e-12, 64, &sum);
+    check(sum.value == 3.5, "series acceleration: Wynn on a finite sum");
+
+    check(num_series_wynn(zero_term, NULL, 1e-12, 64, &sum) == 0 && sum.value == 0.0,
+        "series acceleration: Wynn on a zero series");
+
+    check(num_series_wynn(halving_term, NULL, 1e-12, 64, &sum) == 0 && sum.value == 2.0,
+        "series acceleration: Wynn on sum 2^-n");
+}
+
+int main(void)
+{
+    check_gamma();
+    check_bigint();
+    check_factorial();
+    check_ntt();
+    check_powmod();
+    check_normal();
+    check_sieve();
+    check_binomial();
+    check_power_series();
+    check_pade();
+    check_chebyshev();
+    check_fixed_point();
+    check_cordic();
+    check_trig_table();
+    check_series_plan();
+    check_series_acceleration();
+
+    if (failures)
+    {
+        printf("%d check(s) failed\n", failures);
+    }
+
+    return failures;
+}